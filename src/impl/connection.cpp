@@ -0,0 +1,74 @@
+#include "connection.h"
+#include <algorithm>
+#include <cstring>
+
+#define READ_CHUNK 4096
+
+Connection::Connection(int fd) : fd_(fd), buffer_(READ_CHUNK) {}
+
+char* Connection::prepareRead(size_t min_space) {
+    if (buffer_.size() - end_ < min_space) {
+        buffer_.resize(end_ + std::max<size_t>(min_space, READ_CHUNK));
+    }
+    return buffer_.data() + end_;
+}
+
+void Connection::commitRead(size_t n) {
+    end_ += n;
+}
+
+void Connection::append(const char* data, size_t n) {
+    std::memcpy(prepareRead(n), data, n);
+    commitRead(n);
+}
+
+const HttpRequestParser::ParseResult& Connection::parse() {
+    const auto& result = parser_.parse(buffer_.data() + parsed_, end_ - parsed_);
+    parsed_ = end_;
+    return result;
+}
+
+void Connection::finishRequest() {
+    end_ = 0;
+    parsed_ = 0;
+    parser_.reset();
+}
+
+void Connection::queueOutput(std::string data) {
+    if (!data.empty()) {
+        output_bytes_ += data.size();
+        outgoing_.push_back(std::move(data));
+    }
+}
+
+int Connection::fillIovecs(iovec* iov, int max_iov) const {
+    int count = 0;
+    size_t offset = sent_;
+    for (auto it = outgoing_.begin(); it != outgoing_.end() && count < max_iov; ++it) {
+        iov[count].iov_base = const_cast<char*>(it->data() + offset);
+        iov[count].iov_len = it->size() - offset;
+        offset = 0;
+        count++;
+    }
+    return count;
+}
+
+void Connection::consumeOutput(size_t n) {
+    output_bytes_ -= std::min(n, output_bytes_);
+    while (n > 0 && !outgoing_.empty()) {
+        size_t remaining = outgoing_.front().size() - sent_;
+        if (n < remaining) {
+            sent_ += n;
+            return;
+        }
+        n -= remaining;
+        outgoing_.pop_front();
+        sent_ = 0;
+    }
+}
+
+void Connection::clearOutput() {
+    outgoing_.clear();
+    sent_ = 0;
+    output_bytes_ = 0;
+}
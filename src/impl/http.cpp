@@ -20,7 +20,7 @@ char Http::header_buffer[MAX_HEADER_SIZE];
  * 使用状态机模式逐字符解析HTTP请求，
  * 支持流式处理，不需要等待完整数据
  */
-HttpRequestParser::ParseResult HttpRequestParser::parse(const char* data, size_t len) {
+const HttpRequestParser::ParseResult& HttpRequestParser::parse(const char* data, size_t len) {
     for (size_t i = 0; i < len; ++i) {
         char ch = data[i];
         
@@ -42,6 +42,14 @@ HttpRequestParser::ParseResult HttpRequestParser::parse(const char* data, size_t
     return result_;
 }
 
+void HttpRequestParser::reset() {
+    result_ = ParseResult();
+    currentHeaderField_.clear();
+    currentHeaderValue_.clear();
+    lineBuffer_.clear();
+    expectingHeaderValue_ = false;
+}
+
 /**
  * @brief 解析HTTP请求行
  * @param ch 输入字符
@@ -78,8 +86,6 @@ void HttpRequestParser::parseRequestLine(char ch) {
  * 支持多行头部解析，处理头部字段和值
  */
 void HttpRequestParser::parseHeaders(char ch) {
-    static bool expectingHeaderValue = false;
-    
     if (ch == '\r') {
         return;  // 忽略回车符
     }
@@ -95,25 +101,25 @@ void HttpRequestParser::parseHeaders(char ch) {
             return;
         }
         
-        if (expectingHeaderValue) {
+        if (expectingHeaderValue_) {
             // 完成一个头部字段的解析
             result_.headers[currentHeaderField_] = trim(currentHeaderValue_);
             currentHeaderField_.clear();
             currentHeaderValue_.clear();
-            expectingHeaderValue = false;
+            expectingHeaderValue_ = false;
         }
         lineBuffer_.clear();
         return;
     }
     
-    if (ch == ':' && !expectingHeaderValue) {
-        expectingHeaderValue = true;
+    if (ch == ':' && !expectingHeaderValue_) {
+        expectingHeaderValue_ = true;
         currentHeaderField_ = trim(lineBuffer_);
         lineBuffer_.clear();
         return;
     }
     
-    if (expectingHeaderValue) {
+    if (expectingHeaderValue_) {
         currentHeaderValue_ += ch;
     } else {
         lineBuffer_ += ch;
@@ -7,12 +7,18 @@
 #include <unistd.h>      // close 函数
 #include <cstring>       // memset 函数
 #include <iostream>
+#include <algorithm>
+#include <deque>
+#include <unordered_map>
+#include <pthread.h>     // pthread_setaffinity_np
+#include <sched.h>       // cpu_set_t
 #include "threadpool.h"
 #include "socket.h"
 #include "http.h"
 #include "router.h"
 #include "lru_k_cache.h"
 #include "config.h"
+#include "connection.h"
 
 #define MAX_SIZE 8192
 
@@ -30,65 +36,75 @@ void FrameHeader::Reset() {
     std::fill(data_.begin(), data_.end(), 0);
 }
 
-// 构造函数：初始化端口，设置监听套接字和 epoll 文件描述符的初始值, 设置缓存池大小和k大小
-Server::Server(size_t num_frames, int port, int thread_count, size_t k_dist) 
-    : num_frames_(num_frames),
-      port(port),
-      socka(port),
-      listen_fd(-1), 
-      epoll_fd(-1), 
+Reactor::Reactor(int id, int port) : id(id), listener(port) {}
+
+Reactor::~Reactor() {
+    if (thread.joinable()) thread.join();
+    if (epoll_fd != -1) close(epoll_fd);
+}
+
+// 构造函数：初始化端口，设置缓存池大小和k大小，按配置创建 reactor
+Server::Server(const ServerConfig &config) 
+    : num_frames_(config.num_frames),
+      port(config.port),
+      reactor_count_(config.reactor_count),
+      backend_(config.backend),
+      max_output_bytes_(config.max_output_bytes),
       next_client_id_(0), 
-      thread_pool(thread_count),
+      // 多 reactor 模式和 io_uring 后端都在 reactor 线程内处理请求，不需要线程池
+      thread_pool(config.reactor_count > 0 || config.backend == IoBackend::IO_URING ? 0 : config.thread_count),
       bpm_latch_(std::make_shared<std::mutex>()),
-      cache_(std::make_shared<LRUKCache>(num_frames, k_dist)) {
+      cache_(std::make_shared<LRUKCache>(config.num_frames, config.k_dist)) {
     
     next_client_id_.store(0);
 
     frames_.reserve(num_frames_);
 
     client_table_.reserve(num_frames_);
-    std::cout << "the num_frames is " << num_frames << std::endl;
+    std::cout << "the num_frames is " << num_frames_ << std::endl;
     for (size_t i = 0; i < num_frames_; i++) {
         frames_.push_back(std::make_shared<FrameHeader>(i));
         free_frames_.push_back(static_cast<int>(i));
     }
-}
 
-// 析构函数：关闭监听套接字和 epoll 文件描述符（如果已创建）
-Server::~Server() {
-    if(listen_fd != -1) close(listen_fd);
-    if(epoll_fd != -1) close(epoll_fd);
+    // 经典模式下只有一个 reactor，由 run() 的调用线程驱动
+    int count = reactor_count_ > 0 ? reactor_count_ : 1;
+    for (int i = 0; i < count; i++) {
+        reactors_.push_back(std::make_unique<Reactor>(i, port));
+    }
 }
 
+// 析构函数：reactor 析构时关闭各自的监听套接字和 epoll 文件描述符
+Server::~Server() = default;
 
-auto Server::DeleteClient(client_id_t client_id) -> bool {}
+
+auto Server::DeleteClient(client_id_t client_id) -> bool { return false; }
 
 // 建立并初始化监听 socket
-bool Server::setupSocket() {
-    // 创建 TCP 套接字
-    listen_fd = socket(AF_INET, SOCK_STREAM, 0);
-    if(listen_fd == -1) {
-        logger.error("socket creation failed");
+bool Server::setupSocket(Reactor &reactor) {
+    try {
+        // 绑定套接字到指定地址和端口（SO_REUSEPORT 允许多个 reactor 绑定同一端口）
+        reactor.listener.bind();
+        
+        // 进入监听状态
+        reactor.listener.listen();
+    } catch (const std::exception &e) {
+        logger.error("socket setup failed: " + std::string(e.what()));
         return false;
     }
 
-    // 绑定套接字到指定地址和端口
-    socka.bind();
-    
-    // 进入监听状态
-    socka.listen();
-
-    logger.info("Socket setup complete on port " + std::to_string(port));
+    logger.info("Socket setup complete on port " + std::to_string(port) +
+                " (reactor " + std::to_string(reactor.id) + ")");
     return true;
 }
 
 
 // 初始化 epoll 实例，并将监听套接字添加到 epoll 中
-bool Server::setupEpoll() {
+bool Server::setupEpoll(Reactor &reactor) {
 
     // 创建 epoll 实例，返回一个 epoll 文件描述符
-    epoll_fd = epoll_create1(0);
-    if(epoll_fd == -1) {
+    reactor.epoll_fd = epoll_create1(0);
+    if(reactor.epoll_fd == -1) {
         logger.error("epoll_create1 failed");
         return false;
     }
@@ -96,23 +112,59 @@ bool Server::setupEpoll() {
     // 配置监听套接字的 epoll 事件：
     epoll_event event;
     event.events = EPOLLIN; // 
-    event.data.fd = socka.getListendFd();
+    event.data.fd = reactor.listener.getListendFd();
     // 将监听套接字添加到 epoll 监控列表中
-    if(epoll_ctl(epoll_fd, EPOLL_CTL_ADD, socka.getListendFd(), &event) < 0) {
+    if(epoll_ctl(reactor.epoll_fd, EPOLL_CTL_ADD, reactor.listener.getListendFd(), &event) < 0) {
         logger.error("epoll_ctl failed to add listen_fd");
         return false;
     }
 
-    logger.info("Epoll setup complete", "xxxx");
+    logger.info("Epoll setup complete", "reactor " + std::to_string(reactor.id));
     return true;
 }
 
-// 初始化服务器：建立 socket 和 epoll 实例
-bool Server::init() {
-    if(!setupSocket())
-        return false;
-    if(!setupEpoll())
+// 初始化 io_uring 实例，注册 recv 使用的 provided buffer ring
+bool Server::setupUring(Reactor &reactor) {
+    reactor.ring = std::make_unique<IoUring>(URING_ENTRIES);
+    if (!reactor.ring->Valid() ||
+        !reactor.ring->SetupBufferRing(URING_BUF_GROUP, URING_BUF_COUNT, URING_BUF_SIZE)) {
+        reactor.ring.reset();
         return false;
+    }
+    logger.info("io_uring setup complete", "reactor " + std::to_string(reactor.id));
+    return true;
+}
+
+// 初始化服务器：为每个 reactor 建立 socket 和 epoll/io_uring 实例
+bool Server::init() {
+    for (auto &reactor : reactors_) {
+        if(!setupSocket(*reactor))
+            return false;
+    }
+
+    if (backend_ == IoBackend::IO_URING) {
+        bool ok = true;
+        for (auto &reactor : reactors_) {
+            if (!setupUring(*reactor)) {
+                ok = false;
+                break;
+            }
+        }
+        if (ok) {
+            return true;
+        }
+        // 内核不支持 io_uring（或不支持 buffer ring）时回退到 epoll
+        logger.warning("io_uring unavailable, falling back to epoll", "-");
+        for (auto &reactor : reactors_) {
+            reactor->ring.reset();
+        }
+        backend_ = IoBackend::EPOLL;
+    }
+
+    for (auto &reactor : reactors_) {
+        if(!setupEpoll(*reactor))
+            return false;
+    }
     return true;
 }
 
@@ -162,130 +214,206 @@ void Server::cacheManage(const std::string& cache_key, std::string buf) {
     logger.info("Added new cache entry - path: " + cache_key + ", frame: " + std::to_string(frame_id));
 }
 
-// 处理客户端
-void Server::handleClient(int client_fd) {
-    std::unique_ptr<char[]> buffer(new char[MAX_SIZE]);
-    size_t total_read = 0;
-    ssize_t bytes_read;
+// 根据解析完成的请求生成响应：命中缓存直接返回，否则经由 Router 读取文件并写入缓存
+std::string Server::handleRequest(const HttpRequestParser::ParseResult &request) {
+    const std::string &cache_key = request.path;
+
+    {
+        std::shared_lock<std::shared_mutex> lock(cache_mutex_);
+        auto it = client_table_.find(cache_key);
+        if (it != client_table_.end()) {
+            frame_id_t frame_id = it->second;
+            cache_->RecordAccess(frame_id);
+            return std::string(frames_[frame_id]->GetData());
+        }
+    }
 
-    // 使用状态机解析HTTP请求
-    HttpRequestParser parser;
-    
-    while (true) {
-        bytes_read = read(client_fd, buffer.get() + total_read, MAX_SIZE - total_read);
-        if (bytes_read < 0) {
+    // 生成新响应
+    Router router("/home/zbw/www");
+    std::string response = router.route(request.path, -1, "");
+
+    // 更新缓存
+    cacheManage(cache_key, response);
+    return response;
+}
+
+// 为新接受的连接创建状态并登记到 reactor 的连接表
+std::shared_ptr<Connection> Server::addConnection(Reactor &reactor, int client_fd) {
+    auto conn = std::make_shared<Connection>(client_fd);
+    std::lock_guard<std::mutex> lock(reactor.connections_mutex);
+    reactor.connections[client_fd] = conn;
+    return conn;
+}
+
+std::shared_ptr<Connection> Server::findConnection(Reactor &reactor, int client_fd) {
+    std::lock_guard<std::mutex> lock(reactor.connections_mutex);
+    auto it = reactor.connections.find(client_fd);
+    return it == reactor.connections.end() ? nullptr : it->second;
+}
+
+// 关闭连接并从连接表移除；调用方需持有 conn.mutex
+void Server::closeConnection(Reactor &reactor, Connection &conn) {
+    if (conn.closed) {
+        return;
+    }
+    conn.closed = true;
+    {
+        std::lock_guard<std::mutex> lock(reactor.connections_mutex);
+        reactor.connections.erase(conn.fd());
+    }
+    if (reactor.epoll_fd != -1) {
+        epoll_ctl(reactor.epoll_fd, EPOLL_CTL_DEL, conn.fd(), nullptr);
+    }
+    close(conn.fd());
+}
+
+/**
+ * @brief 解析连接缓冲区中新到达的数据，请求完整时生成响应放入输出队列
+ * @return 解析出完整请求或出错时返回 true
+ *
+ * epoll 与 io_uring 两个后端共用
+ */
+bool Server::processInput(Connection &conn) {
+    const auto &result = conn.parse();
+
+    if (result.state == HttpRequestParser::State::ERROR) {
+        // 发送400错误响应
+        conn.queueOutput(Http::buildResponse("Bad Request", "text/plain", 400));
+        conn.want_close = true;
+        return true;
+    }
+
+    if (result.isComplete()) {
+        bool keep_alive = Http::isKeepAlive(std::string(conn.requestBytes()));
+        conn.queueOutput(handleRequest(result));
+        conn.finishRequest();
+        if (!keep_alive) {
+            conn.want_close = true;
+        }
+        return true;
+    }
+
+    if (conn.buffered() >= MAX_SIZE) {
+        // 请求太大，发送413错误
+        conn.queueOutput(Http::buildResponse("Request Entity Too Large", "text/plain", 413));
+        conn.want_close = true;
+        return true;
+    }
+    return false;
+}
+
+// 用 writev 把输出队列尽量写到 socket，写满时返回 BLOCKED 并保留剩余数据，不做忙等
+Server::FlushResult Server::flushOutput(Connection &conn) {
+    iovec iov[MAX_IOVECS];
+    while (conn.hasPendingOutput()) {
+        int iovcnt = conn.fillIovecs(iov, MAX_IOVECS);
+        ssize_t sent = writev(conn.fd(), iov, iovcnt);
+        if (sent < 0) {
             if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                break;  // 没有更多数据可读
+                return FlushResult::BLOCKED;
             }
-            logger.error("Read error: " + std::string(strerror(errno)));
-            close(client_fd);
-            return;
+            if (errno == EINTR) {
+                continue;
+            }
+            logger.error("Send error: " + std::string(strerror(errno)));
+            conn.clearOutput();
+            return FlushResult::ERROR;
         }
-        if (bytes_read == 0) {
-            close(client_fd);  // 连接已关闭
+        conn.consumeOutput(static_cast<size_t>(sent));
+    }
+    return FlushResult::DONE;
+}
+
+// 根据连接状态计算 epoll 事件：输出积压时关注 EPOLLOUT，超过上限或待关闭时不再关注 EPOLLIN
+bool Server::updateInterest(Reactor &reactor, Connection &conn) {
+    uint32_t events = EPOLLET;
+    if (!conn.want_close && conn.outputBytes() < max_output_bytes_) {
+        events |= EPOLLIN;
+    }
+    if (conn.hasPendingOutput()) {
+        events |= EPOLLOUT;
+    }
+
+    // 经典模式使用 EPOLLONESHOT，每次处理完都要重新装填
+    if (reactor_count_ == 0) {
+        events |= EPOLLONESHOT;
+    } else if (events == conn.epoll_events) {
+        return true;
+    }
+
+    epoll_event event;
+    event.events = events;
+    event.data.fd = conn.fd();
+    if (epoll_ctl(reactor.epoll_fd, EPOLL_CTL_MOD, conn.fd(), &event) < 0) {
+        logger.error("Failed to modify client in epoll");
+        return false;
+    }
+    conn.epoll_events = events;
+    return true;
+}
+
+/**
+ * @brief 处理客户端的可读/可写事件
+ * 先发送积压的输出，再读到 EAGAIN 为止；数据不完整时保留在连接状态中，
+ * socket 写满时登记 EPOLLOUT，等可写后从保存的偏移继续发送
+ */
+void Server::handleClient(Reactor &reactor, const std::shared_ptr<Connection> &conn) {
+    std::lock_guard<std::mutex> guard(conn->mutex);
+    if (conn->closed) {
+        return;
+    }
+
+    while (true) {
+        FlushResult flushed = flushOutput(*conn);
+        if (flushed == FlushResult::ERROR ||
+            (flushed == FlushResult::DONE && conn->want_close)) {
+            closeConnection(reactor, *conn);
             return;
         }
+        // 待关闭或输出超过上限时暂停读取，等 EPOLLOUT 把队列排空
+        if (conn->want_close || conn->outputBytes() >= max_output_bytes_) {
+            break;
+        }
 
-        total_read += bytes_read;
-        auto result = parser.parse(buffer.get(), total_read);
-        
-        if (result.state == HttpRequestParser::State::ERROR) {
-            // 发送400错误响应
-            std::string error_response = Http::buildResponse("Bad Request", "text/plain", 400);
-            send(client_fd, error_response.c_str(), error_response.length(), MSG_NOSIGNAL);
-            close(client_fd);
-            return;
+        if (conn->hasUnparsedInput() && processInput(*conn)) {
+            continue;
         }
-        
-        if (result.isComplete()) {
-            // 处理缓存
-            std::string cache_key = result.path;
-            bool cache_hit = false;
-            
-            {
-                std::shared_lock<std::shared_mutex> lock(cache_mutex_);
-                if (client_table_.find(cache_key) != client_table_.end()) {
-                    frame_id_t frame_id = client_table_[cache_key];
-                    cache_->RecordAccess(frame_id);
-                    
-                    // 使用writev进行聚集写
-                    struct iovec iov[1];
-                    iov[0].iov_base = (void*)frames_[frame_id]->GetData();
-                    iov[0].iov_len = strlen(frames_[frame_id]->GetData());
-                    
-                    ssize_t total_sent = 0;
-                    while (total_sent < iov[0].iov_len) {
-                        ssize_t sent = writev(client_fd, iov, 1);
-                        if (sent < 0) {
-                            if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                                continue;
-                            }
-                            logger.error("Send error: " + std::string(strerror(errno)));
-                            break;
-                        }
-                        total_sent += sent;
-                        iov[0].iov_base = (char*)iov[0].iov_base + sent;
-                        iov[0].iov_len -= sent;
-                    }
-                    cache_hit = true;
-                }
-            }
-            
-            if (!cache_hit) {
-                // 生成新响应
-                Router router("/home/zbw/www");
-                std::string response = router.route(result.path, client_fd, "");
-                
-                // 更新缓存
-                cacheManage(cache_key, response);
-                
-                // 发送响应
-                ssize_t total_sent = 0;
-                while (total_sent < response.length()) {
-                    ssize_t sent = send(client_fd, response.c_str() + total_sent, 
-                                      response.length() - total_sent, MSG_NOSIGNAL);
-                    if (sent < 0) {
-                        if (errno == EAGAIN || errno == EWOULDBLOCK) {
-                            continue;
-                        }
-                        logger.error("Send error: " + std::string(strerror(errno)));
-                        break;
-                    }
-                    total_sent += sent;
-                }
+
+        char *buf = conn->prepareRead(READ_BUFFER_SIZE);
+        ssize_t bytes_read = read(conn->fd(), buf, READ_BUFFER_SIZE);
+        if (bytes_read < 0) {
+            if (errno == EAGAIN || errno == EWOULDBLOCK) {
+                break;  // 没有更多数据可读
             }
-            
-            // 处理keep-alive
-            if (Http::isKeepAlive(std::string(buffer.get()))) {
-                epoll_event event;
-                event.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
-                event.data.fd = client_fd;
-                if (epoll_ctl(epoll_fd, EPOLL_CTL_MOD, client_fd, &event) < 0) {
-                    logger.error("Failed to modify client in epoll");
-                    close(client_fd);
-                }
-            } else {
-                close(client_fd);
+            if (errno == EINTR) {
+                continue;
             }
+            logger.error("Read error: " + std::string(strerror(errno)));
+            closeConnection(reactor, *conn);
             return;
         }
-        
-        if (total_read >= MAX_SIZE) {
-            // 请求太大，发送413错误
-            std::string error_response = Http::buildResponse("Request Entity Too Large", "text/plain", 413);
-            send(client_fd, error_response.c_str(), error_response.length(), MSG_NOSIGNAL);
-            close(client_fd);
+        if (bytes_read == 0) {
+            closeConnection(reactor, *conn);  // 连接已关闭
             return;
         }
+
+        conn->commitRead(static_cast<size_t>(bytes_read));
+        processInput(*conn);
+    }
+
+    if (!updateInterest(reactor, *conn)) {
+        closeConnection(reactor, *conn);
     }
 }
 
 // 处理 epoll 返回的所有事件
-void Server::handleEvents() {
-    epoll_event events[MAX_EVENTS];
+void Server::handleEvents(Reactor &reactor) {
+    std::vector<epoll_event> events(MAX_EVENTS);
+    const int listen_fd = reactor.listener.getListendFd();
+    const bool inline_dispatch = reactor_count_ > 0;
     
     while (true) {
-        int nfds = epoll_wait(epoll_fd, events, MAX_EVENTS, -1);
+        int nfds = epoll_wait(reactor.epoll_fd, events.data(), MAX_EVENTS, -1);
         if(nfds < 0) {
             if (errno == EINTR) {
                 continue;  // 被信号中断，继续等待
@@ -302,37 +430,52 @@ void Server::handleEvents() {
             int fd = events[i].data.fd;
             uint32_t ev = events[i].events;
 
-            if (fd == socka.getListendFd()) {
+            if (fd == listen_fd) {
                 // 批量接受新连接
-                for (int j = 0; j < 16; ++j) {  // 每次最多接受16个新连接
+                for (int j = 0; j < MAX_BATCH_ACCEPT; ++j) {  // 每次最多接受16个新连接
                     std::string client_ip;
-                    int client_fd = socka.acceptConnection(client_ip);
+                    int client_fd = reactor.listener.acceptConnection(client_ip);
                     if (client_fd < 0) {
                         if (errno != EAGAIN && errno != EWOULDBLOCK) {
                             logger.error("Accept failed: " + std::string(strerror(errno)));
                         }
                         break;
                     }
-                    
+
+                    auto added = addConnection(reactor, client_fd);
                     epoll_event client_event;
-                    client_event.events = EPOLLIN | EPOLLET | EPOLLONESHOT;
+                    client_event.events = inline_dispatch ? (EPOLLIN | EPOLLET)
+                                                          : (EPOLLIN | EPOLLET | EPOLLONESHOT);
                     client_event.data.fd = client_fd;
-                    if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, client_fd, &client_event) < 0) {
+                    added->epoll_events = client_event.events;
+                    if (epoll_ctl(reactor.epoll_fd, EPOLL_CTL_ADD, client_fd, &client_event) < 0) {
                         logger.error("Failed to add client to epoll");
-                        close(client_fd);
+                        auto conn = findConnection(reactor, client_fd);
+                        std::lock_guard<std::mutex> guard(conn->mutex);
+                        closeConnection(reactor, *conn);
                         continue;
                     }
                 }
             } else {
+                auto conn = findConnection(reactor, fd);
+                if (!conn) {
+                    continue;
+                }
+
                 if ((ev & EPOLLERR) || (ev & EPOLLHUP)) {
-                    epoll_ctl(epoll_fd, EPOLL_CTL_DEL, fd, nullptr);
-                    close(fd);
+                    std::lock_guard<std::mutex> guard(conn->mutex);
+                    closeConnection(reactor, *conn);
                     continue;
                 }
 
-                if (ev & EPOLLIN) {
-                    batch_tasks.push_back([this, fd]() {
-                        handleClient(fd);
+                if (ev & (EPOLLIN | EPOLLOUT)) {
+                    if (inline_dispatch) {
+                        // 多 reactor 模式：就地处理，不经过线程池
+                        handleClient(reactor, conn);
+                        continue;
+                    }
+                    batch_tasks.push_back([this, &reactor, conn]() {
+                        handleClient(reactor, conn);
                     });
                 }
             }
@@ -345,10 +488,152 @@ void Server::handleEvents() {
     }
 }
 
+namespace {
+
+// io_uring user_data 编码：高 32 位为操作类型，低 32 位为 fd
+enum UringOp : uint64_t { URING_ACCEPT = 1, URING_RECV = 2, URING_SEND = 3 };
+
+inline auto PackUserData(UringOp op, int fd) -> uint64_t {
+    return (static_cast<uint64_t>(op) << 32) | static_cast<uint32_t>(fd);
+}
+
+}  // namespace
+
+// 处理 io_uring 完成事件：accept/recv/send 全部异步提交，一次 io_uring_enter 完成批量提交和等待
+void Server::handleUringEvents(Reactor &reactor) {
+    IoUring &ring = *reactor.ring;
+    const int listen_fd = reactor.listener.getListendFd();
+
+    // 队首数据在 send 完成前保持有效（Connection 的输出队列保证地址稳定）
+    auto startSend = [&ring](Connection &conn) {
+        if (conn.sending || !conn.hasPendingOutput()) {
+            return;
+        }
+        ring.PrepSend(conn.fd(), conn.outputData(), conn.outputSize(), PackUserData(URING_SEND, conn.fd()));
+        conn.sending = true;
+        conn.inflight++;
+    };
+
+    // 所有发送完成后才真正关闭；先 shutdown 让挂起的 multishot recv 结束，再在无在途操作时 close
+    auto maybeClose = [this, &reactor](Connection &conn) {
+        if (!conn.want_close || conn.sending) {
+            return;
+        }
+        if (!conn.shut) {
+            shutdown(conn.fd(), SHUT_RDWR);
+            conn.shut = true;
+        }
+        if (conn.inflight == 0) {
+            closeConnection(reactor, conn);
+        }
+    };
+
+    ring.PrepMultishotAccept(listen_fd, PackUserData(URING_ACCEPT, listen_fd));
+
+    while (true) {
+        int ret = ring.SubmitAndWait(1);
+        if (ret < 0 && ret != -EINTR && ret != -EAGAIN && ret != -EBUSY) {
+            logger.error("io_uring_enter error: " + std::string(strerror(-ret)));
+            break;
+        }
+
+        ring.ForEachCompletion([&](const io_uring_cqe &cqe) {
+            auto op = static_cast<UringOp>(cqe.user_data >> 32);
+            int fd = static_cast<int>(cqe.user_data & 0xffffffffu);
+            bool more = (cqe.flags & IORING_CQE_F_MORE) != 0;
+
+            if (op == URING_ACCEPT) {
+                if (cqe.res >= 0) {
+                    int client_fd = cqe.res;
+                    int opt = 1;
+                    setsockopt(client_fd, IPPROTO_TCP, TCP_NODELAY, &opt, sizeof(opt));
+                    auto conn = addConnection(reactor, client_fd);
+                    ring.PrepMultishotRecv(client_fd, PackUserData(URING_RECV, client_fd));
+                    conn->inflight++;
+                } else if (cqe.res != -EAGAIN) {
+                    logger.error("Accept failed: " + std::string(strerror(-cqe.res)));
+                }
+                if (!more) {
+                    ring.PrepMultishotAccept(listen_fd, PackUserData(URING_ACCEPT, listen_fd));
+                }
+                return;
+            }
+
+            auto conn = findConnection(reactor, fd);
+            if (!conn) {
+                return;
+            }
+
+            if (op == URING_RECV) {
+                if (cqe.res > 0 && (cqe.flags & IORING_CQE_F_BUFFER)) {
+                    auto bid = static_cast<uint16_t>(cqe.flags >> IORING_CQE_BUFFER_SHIFT);
+                    if (!conn->want_close) {
+                        conn->append(ring.BufferData(bid), static_cast<size_t>(cqe.res));
+                    }
+                    ring.RecycleBuffer(bid);
+                } else if (cqe.res != -ENOBUFS) {
+                    // 对端关闭或出错
+                    conn->want_close = true;
+                }
+                if (!more) {
+                    conn->inflight--;
+                    // buffer ring 暂时耗尽或 multishot 被内核终止时重新提交
+                    if (!conn->want_close) {
+                        ring.PrepMultishotRecv(fd, PackUserData(URING_RECV, fd));
+                        conn->inflight++;
+                    }
+                }
+            } else if (op == URING_SEND) {
+                conn->inflight--;
+                conn->sending = false;
+                if (cqe.res < 0) {
+                    logger.error("Send error: " + std::string(strerror(-cqe.res)));
+                    conn->clearOutput();
+                    conn->want_close = true;
+                } else {
+                    conn->consumeOutput(static_cast<size_t>(cqe.res));
+                }
+            }
+
+            // 输出队列低于上限时才解析暂存的输入，实现与 epoll 后端一致的背压
+            while (!conn->want_close && conn->outputBytes() < max_output_bytes_ &&
+                   conn->hasUnparsedInput() && processInput(*conn)) {
+            }
+            startSend(*conn);
+            maybeClose(*conn);
+        });
+    }
+}
+
 // 服务器主循环：不断处理 epoll 事件
 void Server::run() {
     logger.info("Server running on port " + std::to_string(port),"xxxx");
-    while(true) {
-        handleEvents();
+    auto loop = [this](Reactor &reactor) {
+        while(true) {
+            if (backend_ == IoBackend::IO_URING) {
+                handleUringEvents(reactor);
+            } else {
+                handleEvents(reactor);
+            }
+        }
+    };
+
+    if (reactor_count_ == 0) {
+        loop(*reactors_.front());
+    }
+
+    // 多 reactor 模式：每个 reactor 一个线程，并尽量绑定到不同的 CPU 核心
+    unsigned int cores = std::max(1u, std::thread::hardware_concurrency());
+    for (auto &reactor : reactors_) {
+        Reactor *r = reactor.get();
+        r->thread = std::thread([loop, r]() { loop(*r); });
+        cpu_set_t cpuset;
+        CPU_ZERO(&cpuset);
+        CPU_SET(r->id % cores, &cpuset);
+        pthread_setaffinity_np(r->thread.native_handle(), sizeof(cpu_set_t), &cpuset);
+    }
+    logger.info("Started " + std::to_string(reactors_.size()) + " reactors", "xxxx");
+    for (auto &reactor : reactors_) {
+        reactor->thread.join();
     }
 }
@@ -13,7 +13,7 @@
  * @param port 监听端口
  * 直接创建非阻塞socket，提高性能
  */
-Socket::Socket(int port) : port(port) {
+Socket::Socket(int port) : client_fd(-1), port(port) {
     logger.info("Creating socket on port:");
     // 创建非阻塞TCP socket
     listend_fd = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
@@ -25,8 +25,8 @@ Socket::Socket(int port) : port(port) {
 
 Socket::~Socket() {
     logger.info("Closing server socket");
+    // client_fd 只是最近一次 accept 的结果，所有权已交给调用方
     close(listend_fd);
-    close(client_fd);
 }
 
 /**
@@ -37,7 +37,9 @@ void Socket::bind() {
     // TCP优化设置
     int opt = 1;
     // 允许地址重用，快速重启服务器
-    setsockopt(listend_fd, SOL_SOCKET, SO_REUSEADDR | SO_REUSEPORT, &opt, sizeof(opt));
+    setsockopt(listend_fd, SOL_SOCKET, SO_REUSEADDR, &opt, sizeof(opt));
+    // 允许多个 reactor 各自绑定同一端口，由内核做连接负载均衡
+    setsockopt(listend_fd, SOL_SOCKET, SO_REUSEPORT, &opt, sizeof(opt));
     
     // 设置发送和接收缓冲区，提高吞吐量
     int buffer_size = 64 * 1024; // 64KB
@@ -0,0 +1,213 @@
+#include "uring.h"
+#include <sys/mman.h>
+#include <sys/socket.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <string>
+
+namespace {
+
+auto SysSetup(unsigned entries, io_uring_params *p) -> int {
+    return static_cast<int>(syscall(__NR_io_uring_setup, entries, p));
+}
+
+auto SysEnter(int fd, unsigned to_submit, unsigned min_complete, unsigned flags) -> int {
+    return static_cast<int>(syscall(__NR_io_uring_enter, fd, to_submit, min_complete, flags, nullptr, 0));
+}
+
+auto SysRegister(int fd, unsigned opcode, void *arg, unsigned nr_args) -> int {
+    return static_cast<int>(syscall(__NR_io_uring_register, fd, opcode, arg, nr_args));
+}
+
+}  // namespace
+
+/**
+ * @brief 创建 io_uring 实例并映射 SQ/CQ 环
+ * @param entries SQ 深度
+ * 失败时 Valid() 返回 false，由调用方回退到 epoll
+ */
+IoUring::IoUring(unsigned entries) {
+    std::memset(&params_, 0, sizeof(params_));
+    ring_fd_ = SysSetup(entries, &params_);
+    if (ring_fd_ < 0) {
+        logger.error("io_uring_setup failed: " + std::string(strerror(errno)));
+        return;
+    }
+
+    sq_size_ = params_.sq_off.array + params_.sq_entries * sizeof(unsigned);
+    cq_size_ = params_.cq_off.cqes + params_.cq_entries * sizeof(io_uring_cqe);
+    bool single_mmap = (params_.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (single_mmap) {
+        sq_size_ = cq_size_ = std::max(sq_size_, cq_size_);
+    }
+
+    sq_ptr_ = mmap(nullptr, sq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                   IORING_OFF_SQ_RING);
+    if (sq_ptr_ == MAP_FAILED) {
+        sq_ptr_ = nullptr;
+        close(ring_fd_);
+        ring_fd_ = -1;
+        return;
+    }
+    if (single_mmap) {
+        cq_ptr_ = sq_ptr_;
+    } else {
+        cq_ptr_ = mmap(nullptr, cq_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                       IORING_OFF_CQ_RING);
+        if (cq_ptr_ == MAP_FAILED) {
+            cq_ptr_ = nullptr;
+            close(ring_fd_);
+            ring_fd_ = -1;
+            return;
+        }
+    }
+
+    sqes_size_ = params_.sq_entries * sizeof(io_uring_sqe);
+    void *sqes = mmap(nullptr, sqes_size_, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, ring_fd_,
+                      IORING_OFF_SQES);
+    if (sqes == MAP_FAILED) {
+        close(ring_fd_);
+        ring_fd_ = -1;
+        return;
+    }
+    sqes_ = static_cast<io_uring_sqe *>(sqes);
+
+    auto *sq = static_cast<char *>(sq_ptr_);
+    sq_head_ = reinterpret_cast<unsigned *>(sq + params_.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned *>(sq + params_.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned *>(sq + params_.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned *>(sq + params_.sq_off.array);
+    sqe_tail_ = *sq_tail_;
+    // SQ 索引数组采用恒等映射，之后只需推进 tail
+    for (unsigned i = 0; i < params_.sq_entries; i++) {
+        sq_array_[i] = i;
+    }
+
+    auto *cq = static_cast<char *>(cq_ptr_);
+    cq_head_ = reinterpret_cast<unsigned *>(cq + params_.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned *>(cq + params_.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned *>(cq + params_.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe *>(cq + params_.cq_off.cqes);
+
+    logger.info("io_uring initialized with " + std::to_string(params_.sq_entries) + " entries");
+}
+
+IoUring::~IoUring() {
+    if (buf_ring_ != nullptr) {
+        io_uring_buf_reg reg;
+        std::memset(&reg, 0, sizeof(reg));
+        reg.bgid = buf_group_;
+        SysRegister(ring_fd_, IORING_UNREGISTER_PBUF_RING, &reg, 1);
+        munmap(buf_ring_, buf_ring_size_);
+    }
+    if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+    if (cq_ptr_ != nullptr && cq_ptr_ != sq_ptr_) munmap(cq_ptr_, cq_size_);
+    if (sq_ptr_ != nullptr) munmap(sq_ptr_, sq_size_);
+    if (ring_fd_ >= 0) close(ring_fd_);
+}
+
+auto IoUring::SetupBufferRing(uint16_t group_id, unsigned count, unsigned size) -> bool {
+    if (!Valid() || count == 0 || (count & (count - 1)) != 0) {
+        return false;
+    }
+
+    // buffer ring 必须页对齐，直接用匿名映射分配
+    buf_ring_size_ = count * sizeof(io_uring_buf);
+    void *mem = mmap(nullptr, buf_ring_size_, PROT_READ | PROT_WRITE, MAP_ANONYMOUS | MAP_PRIVATE, -1, 0);
+    if (mem == MAP_FAILED) {
+        return false;
+    }
+    std::memset(mem, 0, buf_ring_size_);
+
+    io_uring_buf_reg reg;
+    std::memset(&reg, 0, sizeof(reg));
+    reg.ring_addr = reinterpret_cast<uint64_t>(mem);
+    reg.ring_entries = count;
+    reg.bgid = group_id;
+    if (SysRegister(ring_fd_, IORING_REGISTER_PBUF_RING, &reg, 1) < 0) {
+        logger.error("IORING_REGISTER_PBUF_RING failed: " + std::string(strerror(errno)));
+        munmap(mem, buf_ring_size_);
+        return false;
+    }
+
+    buf_ring_ = static_cast<io_uring_buf_ring *>(mem);
+    buf_count_ = count;
+    buf_size_ = size;
+    buf_group_ = group_id;
+    buf_tail_ = 0;
+    buffers_.assign(static_cast<size_t>(count) * size, 0);
+    for (unsigned i = 0; i < count; i++) {
+        RecycleBuffer(static_cast<uint16_t>(i));
+    }
+    return true;
+}
+
+void IoUring::RecycleBuffer(uint16_t bid) {
+    // 内核头文件中的 bufs 是 C 柔性数组，在 C++ 下会被空结构体错位，这里按偏移 0 手动寻址
+    auto *bufs = reinterpret_cast<io_uring_buf *>(buf_ring_);
+    io_uring_buf *buf = &bufs[buf_tail_ & (buf_count_ - 1)];
+    buf->addr = reinterpret_cast<uint64_t>(BufferData(bid));
+    buf->len = buf_size_;
+    buf->bid = bid;
+    buf_tail_++;
+    __atomic_store_n(&buf_ring_->tail, buf_tail_, __ATOMIC_RELEASE);
+}
+
+auto IoUring::NextSqe() -> io_uring_sqe * {
+    unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    if (sqe_tail_ - head >= params_.sq_entries) {
+        // SQ 已满，先把已有的 SQE 交给内核
+        SubmitAndWait(0);
+        head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+        if (sqe_tail_ - head >= params_.sq_entries) {
+            return nullptr;
+        }
+    }
+    io_uring_sqe *sqe = &sqes_[sqe_tail_ & *sq_mask_];
+    sqe_tail_++;
+    std::memset(sqe, 0, sizeof(*sqe));
+    return sqe;
+}
+
+void IoUring::PrepMultishotAccept(int listen_fd, uint64_t user_data) {
+    io_uring_sqe *sqe = NextSqe();
+    if (sqe == nullptr) return;
+    sqe->opcode = IORING_OP_ACCEPT;
+    sqe->fd = listen_fd;
+    sqe->ioprio = IORING_ACCEPT_MULTISHOT;
+    sqe->accept_flags = SOCK_NONBLOCK;
+    sqe->user_data = user_data;
+}
+
+void IoUring::PrepMultishotRecv(int fd, uint64_t user_data) {
+    io_uring_sqe *sqe = NextSqe();
+    if (sqe == nullptr) return;
+    sqe->opcode = IORING_OP_RECV;
+    sqe->fd = fd;
+    sqe->ioprio = IORING_RECV_MULTISHOT;
+    sqe->flags = IOSQE_BUFFER_SELECT;
+    sqe->buf_group = buf_group_;
+    sqe->user_data = user_data;
+}
+
+void IoUring::PrepSend(int fd, const void *buf, size_t len, uint64_t user_data) {
+    io_uring_sqe *sqe = NextSqe();
+    if (sqe == nullptr) return;
+    sqe->opcode = IORING_OP_SEND;
+    sqe->fd = fd;
+    sqe->addr = reinterpret_cast<uint64_t>(buf);
+    sqe->len = static_cast<uint32_t>(len);
+    sqe->msg_flags = MSG_NOSIGNAL;
+    sqe->user_data = user_data;
+}
+
+auto IoUring::SubmitAndWait(unsigned wait_nr) -> int {
+    __atomic_store_n(sq_tail_, sqe_tail_, __ATOMIC_RELEASE);
+    unsigned to_submit = sqe_tail_ - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    unsigned flags = wait_nr > 0 ? IORING_ENTER_GETEVENTS : 0;
+    int ret = SysEnter(ring_fd_, to_submit, wait_nr, flags);
+    return ret < 0 ? -errno : ret;
+}
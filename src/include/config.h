@@ -1,6 +1,30 @@
 #pragma once
 
 #include <atomic>
+#include <cstddef>
+#include <cstdint>
 
 using frame_id_t = int32_t;    // frame id type
-using client_id_t = int32_t; // client id type
\ No newline at end of file
+using client_id_t = int32_t; // client id type
+
+/**
+ * @brief I/O 事件后端
+ */
+enum class IoBackend {
+    EPOLL,     // epoll 就绪通知 + read/writev/send
+    IO_URING   // io_uring 批量提交 accept/recv/send，不可用时回退到 epoll
+};
+
+/**
+ * @brief 服务器启动配置
+ * 由 main 填充后传给 Server 构造函数
+ */
+struct ServerConfig {
+    size_t num_frames{1024};   // 缓存帧数
+    int port{8080};            // 监听端口
+    int thread_count{4};       // 线程池大小（仅经典模式使用）
+    size_t k_dist{2};          // LRU-K中的K值
+    int reactor_count{0};      // reactor 线程数，0 表示经典模式（单 epoll + 线程池）
+    IoBackend backend{IoBackend::EPOLL};  // I/O 后端
+    size_t max_output_bytes{4 * 1024 * 1024};  // 单连接输出队列上限，超过后暂停读取新请求
+};
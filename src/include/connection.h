@@ -0,0 +1,82 @@
+#pragma once
+
+#include <deque>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <sys/uio.h>
+#include "http.h"
+
+/**
+ * @brief 单个客户端连接在多次 I/O 事件之间保留的状态
+ *
+ * 保存读缓冲区、解析器进度和待发送数据，使得分多次到达的请求
+ * 可以在下一次可读事件中从上次停下的位置继续解析，
+ * 而不是每次从头重新解析整个缓冲区。
+ */
+class Connection {
+public:
+    explicit Connection(int fd);
+
+    int fd() const { return fd_; }
+
+    // ---------- 读缓冲区 ----------
+
+    // 返回可写入新数据的位置，保证至少有 min_space 字节空间
+    char* prepareRead(size_t min_space);
+    // 提交 prepareRead 之后实际读入的字节数
+    void commitRead(size_t n);
+    // 直接追加数据（io_uring 后端从 provided buffer 拷贝）
+    void append(const char* data, size_t n);
+    // 已缓冲但尚未被完整请求消费的字节数
+    size_t buffered() const { return end_; }
+    // 是否有尚未喂给解析器的字节（背压期间暂存的输入）
+    bool hasUnparsedInput() const { return parsed_ < end_; }
+
+    /**
+     * @brief 把上次解析之后新到达的字节喂给解析器
+     * 已解析过的字节不会重复解析
+     */
+    const HttpRequestParser::ParseResult& parse();
+    // 当前请求的原始字节
+    std::string_view requestBytes() const { return std::string_view(buffer_.data(), end_); }
+    // 当前请求处理完毕：丢弃缓冲数据并重置解析器
+    void finishRequest();
+
+    // ---------- 写状态 ----------
+
+    void queueOutput(std::string data);
+    bool hasPendingOutput() const { return !outgoing_.empty(); }
+    // 输出队列中尚未发送的总字节数，用于和单连接上限比较
+    size_t outputBytes() const { return output_bytes_; }
+    // 队首待发送数据及其长度（已跳过发送过的部分）
+    const char* outputData() const { return outgoing_.front().data() + sent_; }
+    size_t outputSize() const { return outgoing_.front().size() - sent_; }
+    // 用输出队列填充 iovec，返回填充的个数，供 writev 一次发送多段数据
+    int fillIovecs(iovec* iov, int max_iov) const;
+    // 记录已发送 n 字节（可跨越多段），发送完毕的段出队
+    void consumeOutput(size_t n);
+    void clearOutput();
+
+    std::mutex mutex;          // 处理该连接的线程持有（经典模式下由线程池线程竞争）
+    bool closed{false};        // 连接已关闭，持有旧引用的线程应直接返回
+    bool want_close{false};    // 待发送数据写完后关闭
+    uint32_t epoll_events{0};  // 当前在 epoll 中注册的事件，兴趣未变化时跳过 EPOLL_CTL_MOD
+
+    // io_uring 后端使用的在途操作状态
+    int inflight{0};           // 尚未完成的 recv/send 数量
+    bool sending{false};       // 是否有 send 在途
+    bool shut{false};          // 是否已 shutdown
+
+private:
+    int fd_;
+    std::vector<char> buffer_;
+    size_t end_{0};            // 有效数据末尾
+    size_t parsed_{0};         // 已喂给解析器的字节数
+    HttpRequestParser parser_;
+
+    std::deque<std::string> outgoing_;  // deque 保证在途 send 引用的数据地址稳定
+    size_t sent_{0};                    // 队首已发送的字节数
+    size_t output_bytes_{0};            // 队列中未发送的总字节数
+};
@@ -28,13 +28,20 @@ public:
         bool isComplete() const { return state == State::FINISHED; }
     };
 
-    ParseResult parse(const char* data, size_t len);
+    /**
+     * @brief 增量解析：只需传入上次调用之后新到达的字节，
+     * 解析状态（当前行、头部字段等）在两次调用之间保留
+     */
+    const ParseResult& parse(const char* data, size_t len);
+    // 清空状态，准备解析同一连接上的下一个请求
+    void reset();
 
 private:
     ParseResult result_;
     std::string currentHeaderField_;
     std::string currentHeaderValue_;
     std::string lineBuffer_;
+    bool expectingHeaderValue_{false};
     
     void parseRequestLine(char ch);
     void parseHeaders(char ch);
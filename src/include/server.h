@@ -6,17 +6,30 @@
 #include <list>
 #include <vector>
 #include <string>
+#include <thread>
+#include <memory>
 #include "logger.h"
 #include "threadpool.h"
 #include "socket.h"
 #include "config.h"
 #include "lru_k_cache.h"
+#include "http.h"
+#include "uring.h"
+#include "connection.h"
 
 // 性能相关常量
 #define MAX_EVENTS 10000
 #define LISTEN_BACKLOG 1024
 #define MAX_BATCH_ACCEPT 16
 #define MAX_SIZE 8192
+#define READ_BUFFER_SIZE 4096
+#define MAX_IOVECS 64
+
+// io_uring 后端参数
+#define URING_ENTRIES 4096
+#define URING_BUF_GROUP 0
+#define URING_BUF_COUNT 1024
+#define URING_BUF_SIZE 4096
 
 /**
  * @brief 帧头部类，用于管理缓存数据
@@ -70,20 +83,45 @@ private:
     Logger logger;
 };
 
+/**
+ * @brief 事件循环（reactor）
+ * 每个 reactor 拥有独立的 epoll 实例和 SO_REUSEPORT 监听 socket，
+ * 由内核在多个监听 socket 之间分摊新连接
+ */
+struct Reactor {
+    Reactor(int id, int port);
+    ~Reactor();
+
+    const int id;
+    Socket listener;
+    int epoll_fd{-1};
+    std::unique_ptr<IoUring> ring;  // 仅 io_uring 后端使用
+    std::thread thread;
+
+    // fd -> 连接状态；经典模式下线程池线程会并发关闭连接，需要加锁
+    std::unordered_map<int, std::shared_ptr<Connection>> connections;
+    std::mutex connections_mutex;
+};
+
 /**
  * @brief 高性能Web服务器类
  * 实现了基于epoll的事件驱动模型和多线程处理
+ *
+ * 两种运行模式：
+ * - 经典模式（reactor_count == 0）：单个 epoll 循环负责 accept，
+ *   可读事件交给线程池处理
+ * - 多 reactor 模式：每个 reactor 线程独立 accept 并就地处理请求，
+ *   没有跨线程的任务队列
+ *
+ * I/O 后端可选 epoll 或 io_uring；io_uring 后端总是在 reactor 线程内就地处理请求
  */
 class Server {
 public:
     /**
      * @brief 构造函数
-     * @param num_frames 缓存帧数
-     * @param port 监听端口
-     * @param thread_count 线程池大小
-     * @param k_dist LRU-K中的K值
+     * @param config 服务器配置（缓存帧数、端口、线程数、K值、reactor数）
      */
-    Server(size_t num_frames, int port, int thread_count, size_t k_dist);
+    explicit Server(const ServerConfig &config);
     ~Server();
 
     // 初始化服务器（socket, epoll 等）
@@ -95,9 +133,10 @@ private:
     // 服务器配置
     size_t num_frames_;
     int port;
-    Socket socka;
-    int listen_fd;
-    int epoll_fd;
+    int reactor_count_;
+    IoBackend backend_;
+    size_t max_output_bytes_;
+    std::vector<std::unique_ptr<Reactor>> reactors_;
 
     // 线程池相关
     std::atomic<client_id_t> next_client_id_;
@@ -152,13 +191,33 @@ private:
     // bool setNonBlocking(int fd);
 
     // 建立并初始化监听 socket
-    bool setupSocket();
+    bool setupSocket(Reactor &reactor);
     // 初始化 epoll 实例，并将监听 socket 添加到 epoll
-    bool setupEpoll();
+    bool setupEpoll(Reactor &reactor);
+    // 初始化 io_uring 实例和 provided buffer ring
+    bool setupUring(Reactor &reactor);
     // 处理 epoll 返回的事件
-    void handleEvents();
-
-    void handleClient(int client_fd);
+    void handleEvents(Reactor &reactor);
+    // 处理 io_uring 完成事件
+    void handleUringEvents(Reactor &reactor);
+
+    void handleClient(Reactor &reactor, const std::shared_ptr<Connection> &conn);
+
+    // 连接表管理
+    std::shared_ptr<Connection> addConnection(Reactor &reactor, int client_fd);
+    std::shared_ptr<Connection> findConnection(Reactor &reactor, int client_fd);
+    void closeConnection(Reactor &reactor, Connection &conn);
+
+    // 解析新到达的数据，完整请求的响应放入连接输出队列
+    bool processInput(Connection &conn);
+    // 把连接输出队列写入 socket
+    enum class FlushResult { DONE, BLOCKED, ERROR };
+    FlushResult flushOutput(Connection &conn);
+    // 按连接当前状态更新 epoll 关注的事件（有积压输出时关注 EPOLLOUT）
+    bool updateInterest(Reactor &reactor, Connection &conn);
+
+    // 根据解析完成的请求生成完整响应（查缓存或经由 Router 读取文件）
+    std::string handleRequest(const HttpRequestParser::ParseResult &request);
 
     auto DeleteClient(client_id_t client_id) -> bool;
 
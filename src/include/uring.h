@@ -0,0 +1,99 @@
+#pragma once
+
+#include <linux/io_uring.h>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+#include "logger.h"
+
+/**
+ * @brief 基于原始系统调用的最小 io_uring 封装
+ * 不依赖 liburing，只实现服务器需要的操作：
+ * multishot accept、使用 provided buffer ring 的 multishot recv 以及 send。
+ * 一个 IoUring 实例只能由一个线程使用。
+ */
+class IoUring {
+public:
+    explicit IoUring(unsigned entries);
+    ~IoUring();
+
+    IoUring(const IoUring &) = delete;
+    IoUring &operator=(const IoUring &) = delete;
+
+    auto Valid() const -> bool { return ring_fd_ >= 0; }
+
+    /**
+     * @brief 注册 provided buffer ring（内核 5.19+）
+     * @param group_id 缓冲区组ID，recv 时由内核从该组中挑选缓冲区
+     * @param count 缓冲区个数，必须是2的幂
+     * @param size 每个缓冲区的大小
+     */
+    auto SetupBufferRing(uint16_t group_id, unsigned count, unsigned size) -> bool;
+    auto BufferData(uint16_t bid) -> char * { return buffers_.data() + static_cast<size_t>(bid) * buf_size_; }
+    // 把内核借出的缓冲区归还到 buffer ring
+    void RecycleBuffer(uint16_t bid);
+
+    void PrepMultishotAccept(int listen_fd, uint64_t user_data);
+    void PrepMultishotRecv(int fd, uint64_t user_data);
+    void PrepSend(int fd, const void *buf, size_t len, uint64_t user_data);
+
+    /**
+     * @brief 提交所有待提交的 SQE，并至少等待 wait_nr 个完成事件
+     * 一次 io_uring_enter 同时完成提交和等待
+     * @return 成功时返回提交的 SQE 数，失败返回 -errno
+     */
+    auto SubmitAndWait(unsigned wait_nr) -> int;
+
+    /**
+     * @brief 遍历并消费所有已就绪的 CQE
+     */
+    template <typename Fn>
+    auto ForEachCompletion(Fn &&fn) -> unsigned {
+        unsigned head = *cq_head_;
+        unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+        unsigned count = 0;
+        while (head != tail) {
+            fn(cqes_[head & *cq_mask_]);
+            head++;
+            count++;
+        }
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        return count;
+    }
+
+private:
+    auto NextSqe() -> io_uring_sqe *;
+
+    int ring_fd_{-1};
+    io_uring_params params_{};
+
+    // SQ/CQ 共享内存映射
+    void *sq_ptr_{nullptr};
+    size_t sq_size_{0};
+    void *cq_ptr_{nullptr};
+    size_t cq_size_{0};
+    io_uring_sqe *sqes_{nullptr};
+    size_t sqes_size_{0};
+
+    unsigned *sq_head_{nullptr};
+    unsigned *sq_tail_{nullptr};
+    unsigned *sq_mask_{nullptr};
+    unsigned *sq_array_{nullptr};
+    unsigned sqe_tail_{0};  // 本地维护的 SQ 尾指针，提交时才发布给内核
+
+    unsigned *cq_head_{nullptr};
+    unsigned *cq_tail_{nullptr};
+    unsigned *cq_mask_{nullptr};
+    io_uring_cqe *cqes_{nullptr};
+
+    // provided buffer ring
+    io_uring_buf_ring *buf_ring_{nullptr};
+    size_t buf_ring_size_{0};
+    unsigned buf_count_{0};
+    unsigned buf_size_{0};
+    uint16_t buf_group_{0};
+    uint16_t buf_tail_{0};
+    std::vector<char> buffers_;
+
+    Logger logger;
+};
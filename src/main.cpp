@@ -15,8 +15,26 @@ int main(int argc, char *argv[]) {
     size_t num_frames = (memory_mb * 1024 * 1024) / MAX_SIZE;  // 根据期望内存大小计算帧数
     size_t k_dist = 2;  // LRU-K中的K值
     int port = 8080;  // 服务端口
+    int reactor_count = 0;  // reactor 数量，0 为经典模式；--reactors N 开启多 reactor 模式（N<0 表示每个核心一个）
+    IoBackend backend = IoBackend::EPOLL;  // --backend uring 选择 io_uring 后端
+    for (int i = 1; i + 1 < argc; i++) {
+        if (std::string(argv[i]) == "--reactors") {
+            reactor_count = std::stoi(argv[i + 1]);
+            if (reactor_count < 0) reactor_count = cpu_cores;
+        } else if (std::string(argv[i]) == "--backend") {
+            backend = std::string(argv[i + 1]) == "uring" ? IoBackend::IO_URING : IoBackend::EPOLL;
+        }
+    }
+
+    ServerConfig config;
+    config.num_frames = num_frames;
+    config.port = port;
+    config.thread_count = thread_count;
+    config.k_dist = k_dist;
+    config.reactor_count = reactor_count;
+    config.backend = backend;
     // 创建一个服务器实例，监听 8080 端口
-    Server server(num_frames, port, thread_count, k_dist); // size_t num_frames, int port, int thread_count, size_t k_dist
+    Server server(config);
     
     // 输出配置信息
     std::cout << "Server Configuration:" << std::endl
@@ -24,6 +42,8 @@ int main(int argc, char *argv[]) {
               << "- Cache Frames: " << num_frames << std::endl
               << "- Cache Size: " << (num_frames * MAX_SIZE / 1024 / 1024) << "MB" << std::endl
               << "- LRU-K Value: " << k_dist << std::endl
+              << "- I/O Backend: " << (backend == IoBackend::IO_URING ? "io_uring" : "epoll") << std::endl
+              << "- Reactors: " << (reactor_count > 0 ? std::to_string(reactor_count) : "classic") << std::endl
               << "- Port: " << port << std::endl;
     
     if (!server.init()) {